@@ -8,6 +8,16 @@
  *  - Borrowing limit (3 for Student, 5 for Faculty)
  *  - Borrowing period (15 days / 30 days)
  *  - Writes data to BookData.csv, AccountData.csv
+ *  - Optional multi-branch catalogs: one book file per branch (shard),
+ *    or books hash-partitioned by ISBN across several files
+ *  - Copy-on-write snapshots so reports read a consistent catalog while
+ *    borrows and returns carry on
+ *  - Screens redrawn with ANSI escapes and written in one go; plain
+ *    streaming output when not attached to a terminal
+ *  - Hold queues: borrowing a book that is out puts you in line, and a
+ *    return reserves the book for the next patron for a few days
+ *  - "Patrons also borrowed" recommendations from returned-book histories
+ *  - Bulk import of publisher CSV feeds, merged into the catalog by ISBN
  *****************************************************************************/
 
 #include <iostream>
@@ -17,17 +27,112 @@
 #include <sstream>
 #include <ctime>
 #include <algorithm>
+#include <thread>
+#include <future>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <deque>
+#include <unordered_map>
+#include <map>
+#include <set>
+#include <cerrno>
+#include <cstdlib>
+#include <cctype>
+#include <chrono>
+#if defined _WIN32
+#define NOMINMAX
+#include <io.h>
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
 using namespace std;
 
-// Cross-platform screen clear
-void Clear() {
+// True if stdout is an interactive terminal that understands ANSI escapes.
+// On Windows this also switches the console into VT mode.
+bool stdoutIsTerminal() {
 #if defined _WIN32
-    system("cls");
+    if(!_isatty(_fileno(stdout))) return false;
+    HANDLE h = GetStdHandle(STD_OUTPUT_HANDLE);
+    DWORD mode = 0;
+    if(!GetConsoleMode(h, &mode)) return false;
+    return SetConsoleMode(h, mode | 0x0004) != 0; // ENABLE_VIRTUAL_TERMINAL_PROCESSING
 #else
-    system("clear");
+    return isatty(STDOUT_FILENO) != 0;
 #endif
 }
 
+// Cross-platform screen clear, without spawning "clear"/"cls":
+// cursor home + erase screen. When output goes to a pipe or file there is
+// no screen to clear, so nothing is written and the output just streams.
+void Clear() {
+    static const bool tty = stdoutIsTerminal();
+    if(tty) cout<<"\033[H\033[2J";
+}
+
+// ---------------------------------------------------------------------
+// Class: FrameBuffer
+//   - Installed on cout for the life of main()
+//   - Collects a whole screen and hands it to the OS in one write() when
+//     cout is flushed. cin is tied to cout, so that happens once per
+//     screen, right before we wait for input: no half-drawn menus.
+//   - Very long screens (big listings) are flushed every MAX_FRAME bytes
+//   - Locked, since worker threads may still print (cerr is tied to
+//     cout, so each cerr write flushes this buffer too)
+// ---------------------------------------------------------------------
+class FrameBuffer : public streambuf {
+private:
+    static const size_t MAX_FRAME = 1<<20;
+    string     frame;
+    streambuf* prev;
+    mutex      mtx;
+
+    bool writeOut() {
+        size_t done = 0;
+        while(done < frame.size()) {
+#if defined _WIN32
+            int n = _write(1, frame.data()+done, (unsigned)(frame.size()-done));
+#else
+            ssize_t n = write(STDOUT_FILENO, frame.data()+done, frame.size()-done);
+#endif
+            if(n<0 && errno==EINTR) continue;
+            if(n<=0) { frame.clear(); return false; }
+            done += (size_t)n;
+        }
+        frame.clear();
+        return true;
+    }
+
+protected:
+    int_type overflow(int_type c) override {
+        if(traits_type::eq_int_type(c, traits_type::eof())) return traits_type::not_eof(c);
+        lock_guard<mutex> g(mtx);
+        frame.push_back(traits_type::to_char_type(c));
+        if(frame.size()>=MAX_FRAME && !writeOut()) return traits_type::eof();
+        return c;
+    }
+    streamsize xsputn(const char* s, streamsize n) override {
+        lock_guard<mutex> g(mtx);
+        frame.append(s, (size_t)n);
+        if(frame.size()>=MAX_FRAME && !writeOut()) return 0;
+        return n;
+    }
+    int sync() override {
+        lock_guard<mutex> g(mtx);
+        return writeOut() ? 0 : -1;
+    }
+
+public:
+    FrameBuffer() : prev(cout.rdbuf(this)) {}
+    ~FrameBuffer() {
+        cout.flush();
+        cout.rdbuf(prev);
+    }
+    FrameBuffer(const FrameBuffer&) = delete;
+    FrameBuffer& operator=(const FrameBuffer&) = delete;
+};
+
 // We'll store a "day number" from epoch for dueDate/borrowDate
 // A simple helper: get current day count from epoch
 int currentDayFromEpoch() {
@@ -40,10 +145,109 @@ int diffInDays(int day1, int day2) {
     return (day1 - day2);
 }
 
+// FNV-1a hash of an ISBN. Used to pick the owning shard when the catalog
+// is hash-partitioned; unlike std::hash it is stable across compilers,
+// so a book always lands in the same file from one run to the next.
+uint32_t isbnHash(const string &isbn) {
+    uint32_t h = 2166136261u;
+    for(unsigned char c : isbn) {
+        h ^= c;
+        h *= 16777619u;
+    }
+    return h;
+}
+
+// ISBN with only its digits and check letter kept, so "978-0132350884",
+// "9780132350884" and "978 0132350884" compare equal
+string isbnKey(const string &isbn) {
+    string key;
+    for(unsigned char c : isbn) {
+        if(isdigit(c))            key += (char)c;
+        else if(c=='x' || c=='X') key += 'X';
+    }
+    return key;
+}
+
+// Copy of "s" without leading/trailing spaces and tabs
+string trimmed(const string &s) {
+    size_t b = s.find_first_not_of(" \t");
+    if(b==string::npos) return "";
+    size_t e = s.find_last_not_of(" \t");
+    return s.substr(b, e-b+1);
+}
+
+// ---------------------------------------------------------------------
+// Class: HoldQueue
+//  - Patrons waiting for one title; the Library keeps one per title, so
+//    a return of any copy in any branch serves it
+//  - Faculty are served before students; first come first served within
+//    each role. push() and pop() are O(1).
+//  - Saved as "F:FAC456;S:STU123"
+// ---------------------------------------------------------------------
+class HoldQueue {
+private:
+    deque<string> faculty;   // userIDs
+    deque<string> students;
+
+public:
+    static const int PICKUP_DAYS = 3; // how long a returned book waits
+
+    bool   empty() const { return faculty.empty() && students.empty(); }
+    size_t size() const  { return faculty.size() + students.size(); }
+
+    void push(const string &userID, bool isFaculty) {
+        if(isFaculty) faculty.push_back(userID);
+        else          students.push_back(userID);
+    }
+
+    // Next holder in priority order, "" if nobody is waiting
+    string pop() {
+        deque<string> &q = faculty.empty() ? students : faculty;
+        if(q.empty()) return "";
+        string id = q.front();
+        q.pop_front();
+        return id;
+    }
+
+    // i-th holder in priority order, i < size()
+    const string& operator[](size_t i) const {
+        return (i<faculty.size()) ? faculty[i] : students[i-faculty.size()];
+    }
+
+    // 1-based place in line, 0 if not waiting
+    size_t position(const string &userID) const {
+        for(size_t i=0; i<faculty.size(); i++) {
+            if(faculty[i]==userID) return i+1;
+        }
+        for(size_t i=0; i<students.size(); i++) {
+            if(students[i]==userID) return faculty.size()+i+1;
+        }
+        return 0;
+    }
+
+    string toString() const {
+        string out;
+        for(size_t i=0; i<faculty.size(); i++)  out += (out.empty() ? "" : ";") + ("F:" + faculty[i]);
+        for(size_t i=0; i<students.size(); i++) out += (out.empty() ? "" : ";") + ("S:" + students[i]);
+        return out;
+    }
+
+    void parse(const string &s) {
+        stringstream ss(s);
+        string item;
+        while(getline(ss,item,';')) {
+            if(item.size()<3 || item[1]!=':') continue;
+            push(item.substr(2), item[0]=='F');
+        }
+    }
+};
+
 // ---------------------------------------------------------------------
 // Class: Book
-//  - "status" = "Available" or "Borrowed"
+//  - "status" = "Available", "Borrowed" or "Reserved"
 //  - "borrowDate" & "dueDate": store day-from-epoch
+//  - While "Reserved", borrowedBy is the patron it is held for and
+//    dueDate is the last day they can pick it up
 // ---------------------------------------------------------------------
 class Book {
 private:
@@ -52,7 +256,7 @@ private:
     string  isbn;
     string  publisher;
     int     year;
-    string  status;       // "Available" or "Borrowed"
+    string  status;       // "Available", "Borrowed" or "Reserved"
     int     borrowDate;   // day-from-epoch
     int     dueDate;      // day-from-epoch
     string  borrowedBy;   // userID or "-None-"
@@ -94,10 +298,30 @@ public:
         if(status=="Borrowed") {
             cout <<", dueDay="<<dueDate;
         }
+        if(status=="Reserved") {
+            cout <<", pickupBy="<<dueDate;
+        }
         cout<<"\n";
     }
 };
 
+// ---------------------------------------------------------------------
+// Struct: VersionClock
+//   - Shared by the Library and all its users
+//   - "seq" is bumped by every change to a user's fine or history
+//   - "openSnapshots" counts live CatalogSnapshots; while it is >0, users
+//     keep the values they overwrite so a snapshot can still read them
+//   - "mtx" is the library-wide commit lock: a borrow/return holds it for
+//     its whole update, and a snapshot holds it while it is taken
+// ---------------------------------------------------------------------
+struct VersionClock {
+    recursive_mutex mtx;
+    long long       seq;
+    int             openSnapshots;
+
+    VersionClock() : seq(0), openSnapshots(0) {}
+};
+
 // ---------------------------------------------------------------------
 // Abstract base: User
 //   - Derived: Student, Faculty, Librarian
@@ -112,32 +336,75 @@ protected:
     int    fine;  // for students
     vector<string> borrowHistory; // list of titles previously returned
 
+    // Versioned records for snapshots: (seq that replaced it, old value).
+    // Only filled while a snapshot is open; cleared on the next change after.
+    VersionClock* clock; // null until the Library adopts this user
+    vector<pair<long long,int>>    fineVersions;
+    vector<pair<long long,size_t>> historyVersions; // old history length
+
 public:
     User(const string &nm, const string &id)
-       : name(nm), userID(id), fine(0) {}
+       : name(nm), userID(id), fine(0), clock(nullptr) {}
     virtual ~User() {}
 
+    void setClock(VersionClock* c) { clock = c; }
+
     string getName() const   { return name; }
     string getUserID() const { return userID; }
     int    getFine() const   { return fine; }
 
     void setName(const string &n)   { name = n; }
     void setUserID(const string &id){ userID = id; }
-    void setFine(int f)             { fine = f; }
+    void setFine(int f) {
+        if(!clock) { fine = f; return; }
+        lock_guard<recursive_mutex> g(clock->mtx);
+        long long s = ++clock->seq;
+        if(clock->openSnapshots>0) fineVersions.push_back({s, fine});
+        else fineVersions.clear();
+        fine = f;
+    }
+
+    // Fine as it was when a snapshot at sequence "seq" was taken
+    int getFineAt(long long seq) const {
+        if(!clock) return fine;
+        lock_guard<recursive_mutex> g(clock->mtx);
+        for(auto &v : fineVersions) {
+            if(v.first > seq) return v.second;
+        }
+        return fine;
+    }
 
     // Borrowing & returning are specialized
     //  - canBorrowMore(...) is used by the system to check user constraints
     //  - getBorrowDays() returns 15 or 30
     //  - handleOverdueBook(...) adds a fine if the user is a Student
-    virtual bool canBorrowMore(const vector<Book*> &myBooks) = 0;
+    virtual bool canBorrowMore(int booksOut) = 0;
     virtual int  getBorrowDays() = 0; 
     virtual void handleOverdueBook(int daysOverdue) = 0; 
 
     // Add to history
     void addHistory(const string &title) {
+        if(!clock) { borrowHistory.push_back(title); return; }
+        lock_guard<recursive_mutex> g(clock->mtx);
+        long long s = ++clock->seq;
+        if(clock->openSnapshots>0) historyVersions.push_back({s, borrowHistory.size()});
+        else historyVersions.clear();
         borrowHistory.push_back(title);
     }
 
+    const vector<string>& getHistory() const { return borrowHistory; }
+
+    // History is append-only, so a snapshot just sees a shorter prefix
+    vector<string> getHistoryAt(long long seq) const {
+        if(!clock) return borrowHistory;
+        lock_guard<recursive_mutex> g(clock->mtx);
+        size_t len = borrowHistory.size();
+        for(auto &v : historyVersions) {
+            if(v.first > seq) { len = v.second; break; }
+        }
+        return vector<string>(borrowHistory.begin(), borrowHistory.begin()+len);
+    }
+
     // Print history
     void showHistory() const {
         if(borrowHistory.empty()) {
@@ -176,11 +443,11 @@ public:
     Student(const string &nm, const string &id)
        : User(nm, id) {}
 
-    bool canBorrowMore(const vector<Book*> &myBooks) override {
+    bool canBorrowMore(int booksOut) override {
         // block if fines >0
         if(hasUnpaidFines()) return false;
         // block if >=3 borrowed
-        if((int)myBooks.size() >= MAX_BOOKS) return false;
+        if(booksOut >= MAX_BOOKS) return false;
         return true;
     }
 
@@ -229,9 +496,9 @@ public:
     Faculty(const string &nm, const string &id)
        : User(nm, id) {}
 
-    bool canBorrowMore(const vector<Book*> &myBooks) override {
+    bool canBorrowMore(int booksOut) override {
         // check if already 5
-        if((int)myBooks.size()>= MAX_BOOKS) return false;
+        if(booksOut >= MAX_BOOKS) return false;
         // We also check if any is overdue >60 in the library code
         // to block new borrowing. 
         return true; 
@@ -258,7 +525,7 @@ public:
     Librarian(const string &nm, const string &id)
        : User(nm, id) {}
 
-    bool canBorrowMore(const vector<Book*> &myBooks) override {
+    bool canBorrowMore(int booksOut) override {
         return false; // Librarian doesn't borrow
     }
     int getBorrowDays() override {
@@ -300,39 +567,139 @@ public:
 };
 
 // ---------------------------------------------------------------------
-// Class: Library
-//   - Manages a vector<Book> and vector<Account>
-//   - On startup, loads from CSV. On destruction, saves to CSV.
-//   - Rebuilds "which books a user currently has" by scanning BookData
-//     for "borrowedBy = that userID" each time we log in
+// Class: CowPages<T>
+//   - A vector split into fixed-size pages, each held by shared_ptr
+//   - snapshot() copies only the page-table pointer: O(1)
+//   - A write copies the page table and the page it touches, but only
+//     while a snapshot still shares them. So the extra memory is bounded
+//     by the pages changed while snapshots are open.
+//   - Not locked itself; the Library serializes writers against
+//     snapshot() with its commit lock (VersionClock::mtx)
 // ---------------------------------------------------------------------
-class Library {
+template<class T>
+class CowPages {
+public:
+    static const size_t PAGE_SIZE = 64;
+    typedef vector<T>                Page;
+    typedef vector<shared_ptr<Page>> Table;
+
+    // Read-only point-in-time view; keeps the pages it sees alive
+    class View {
+    private:
+        shared_ptr<const Table> table;
+        size_t count;
+    public:
+        View(shared_ptr<const Table> t, size_t n) : table(t), count(n) {}
+        size_t   size() const         { return count; }
+        const T& at(size_t i) const   { return (*(*table)[i/PAGE_SIZE])[i%PAGE_SIZE]; }
+    };
+
 private:
-    vector<Book>    books;
-    vector<Account> accounts;
+    shared_ptr<Table> root;
+    size_t count;
+
+    // Pages are always reserved to full size so pointers into a page stay
+    // valid while it fills up
+    static shared_ptr<Page> newPage(const Page &from = Page()) {
+        auto p = make_shared<Page>();
+        p->reserve(PAGE_SIZE);
+        p->insert(p->end(), from.begin(), from.end());
+        return p;
+    }
+
+    // Make the table and page "pg" ours alone before writing into them
+    Page& writablePage(size_t pg) {
+        if(root.use_count()>1) root = make_shared<Table>(*root);
+        shared_ptr<Page> &p = (*root)[pg];
+        if(p.use_count()>1) p = newPage(*p);
+        return *p;
+    }
 
 public:
-    Library() {
-        loadBooks("BookData.csv");
-        loadAccounts("AccountData.csv");
+    CowPages() : root(make_shared<Table>()), count(0) {}
+
+    size_t   size() const          { return count; }
+    bool     empty() const         { return count==0; }
+    const T& at(size_t i) const    { return (*(*root)[i/PAGE_SIZE])[i%PAGE_SIZE]; }
+    View     snapshot() const      { return View(root, count); }
+
+    // Position of an element obtained from at(), or size() if not ours
+    size_t indexOf(const T* p) const {
+        for(size_t pg=0; pg<root->size(); pg++) {
+            const Page &page = *(*root)[pg];
+            if(!page.empty() && p >= &page.front() && p <= &page.back()) {
+                return pg*PAGE_SIZE + (p - &page.front());
+            }
+        }
+        return count;
     }
-    ~Library() {
-        saveBooks("BookData.csv");
-        saveAccounts("AccountData.csv");
-        // Also must delete the user objects allocated in loadAccounts
-        for(auto &acc : accounts) {
-            delete acc.getUser();
+
+    T& edit(size_t i) {
+        return writablePage(i/PAGE_SIZE)[i%PAGE_SIZE];
+    }
+
+    void push_back(const T &v) {
+        if(count%PAGE_SIZE==0) {
+            if(root.use_count()>1) root = make_shared<Table>(*root);
+            root->push_back(newPage());
+        }
+        writablePage(count/PAGE_SIZE).push_back(v);
+        count++;
+    }
+
+    // Removes every element matching "pred" and returns the removed copies.
+    // The kept ones are repacked into fresh pages; any snapshot keeps the old.
+    template<class Pred>
+    vector<T> extractIf(Pred pred) {
+        vector<T> out;
+        CowPages<T> kept;
+        for(size_t i=0; i<count; i++) {
+            const T &v = at(i);
+            if(pred(v)) out.push_back(v);
+            else kept.push_back(v);
         }
+        if(!out.empty()) {
+            root  = kept.root;
+            count = kept.count;
+        }
+        return out;
     }
+};
+
+// ---------------------------------------------------------------------
+// Class: LibraryShard
+//   - One branch of the catalog (or one ISBN hash partition)
+//   - Owns its own book file, e.g. "BookData.csv"
+//   - "dirty" is set on any change so untouched shards are not rewritten
+//   - Books are kept in CowPages so snapshots can share them; every
+//     change goes through update()/addBook()/extractIf()
+// ---------------------------------------------------------------------
+class LibraryShard {
+private:
+    string         name;      // branch name, shown in listings
+    string         bookFile;
+    CowPages<Book> books;
+    bool           dirty;
+
+public:
+    LibraryShard(const string &nm, const string &file)
+      : name(nm), bookFile(file), dirty(false) {}
+
+    string getName() const     { return name; }
+    string getBookFile() const { return bookFile; }
+    bool   isDirty() const     { return dirty; }
+    const CowPages<Book>& getBooks() const { return books; }
 
     // ----------------------------
     // Book I/O
     // ----------------------------
-    void loadBooks(const string &fname) {
-        ifstream fin(fname);
+
+    // Runs on a loader thread, so instead of printing it returns a
+    // warning for the caller to show ("" if none)
+    string loadBooks() {
+        ifstream fin(bookFile);
         if(!fin.is_open()) {
-            cerr<<"Could not open "<<fname<<". Will create on save.\n";
-            return;
+            return "Could not open "+bookFile+". Will create on save.";
         }
         string line;
         while(getline(fin, line)) {
@@ -361,12 +728,12 @@ public:
             books.push_back(b);
         }
         fin.close();
+        return "";
     }
 
-    void saveBooks(const string &fname) {
-        ofstream fout(fname, ios::out);
-        for(size_t i=0; i<books.size(); i++){
-            Book &b = books[i];
+    static void writeBooks(ofstream &fout, const CowPages<Book>::View &view) {
+        for(size_t i=0; i<view.size(); i++){
+            const Book &b = view.at(i);
             fout<<b.getTitle()<<","
                 <<b.getAuthor()<<","
                 <<b.getISBN()<<","
@@ -376,49 +743,836 @@ public:
                 <<b.getBorrowDate()<<","
                 <<b.getDueDate()<<","
                 <<b.getBorrowedBy();
-            if(i<books.size()-1) fout<<"\n";
+            if(i<view.size()-1) fout<<"\n";
         }
+    }
+
+    void saveBooks() {
+        ofstream fout(bookFile, ios::out);
+        writeBooks(fout, books.snapshot());
         fout.close();
+        dirty = false;
     }
 
-    // For convenience in code
-    Book* findBookByTitle(const string &title) {
-        for(auto &b : books) {
-            if(b.getTitle()==title) return &b;
+    // Appends every copy whose title (or ISBN) is "key"
+    void findCopies(const string &key, bool byISBN, vector<const Book*> &out) const {
+        for(size_t i=0; i<books.size(); i++) {
+            const Book &b = books.at(i);
+            if((byISBN ? b.getISBN() : b.getTitle())==key) out.push_back(&b);
+        }
+    }
+
+    // True if "b" points into this shard's live storage
+    bool owns(const Book* b) const {
+        return books.indexOf(b) < books.size();
+    }
+
+    // Applies "fn" to a writable copy of "b" and returns where it now lives.
+    // The old pointer may belong to a snapshot afterwards, so use the result.
+    // Returns nullptr, changing nothing, if "b" is not in this shard.
+    template<class Fn>
+    const Book* update(const Book* b, Fn fn) {
+        return updateAt(books.indexOf(b), fn);
+    }
+
+    // Same, by position in getBooks()
+    template<class Fn>
+    const Book* updateAt(size_t i, Fn fn) {
+        if(i>=books.size()) return nullptr;
+        Book &w = books.edit(i);
+        fn(w);
+        dirty = true;
+        return &w;
+    }
+
+    void addBook(const Book &b) {
+        books.push_back(b);
+        dirty = true;
+    }
+
+    // Removes every book matching "pred" and returns the removed copies
+    template<class Pred>
+    vector<Book> extractIf(Pred pred) {
+        vector<Book> out = books.extractIf(pred);
+        if(!out.empty()) dirty = true;
+        return out;
+    }
+};
+
+// ---------------------------------------------------------------------
+// Class: CoBorrowIndex
+//   - "Patrons also borrowed": for two titles, how many users have
+//     returned both
+//   - build() counts every user's history at load in parallel and
+//     stores the result as CSR (compressed sparse rows):
+//     row i = the titles borrowed alongside title i, strongest first,
+//     pruned to MAX_ROW entries
+//   - Returns after that go into a small per-title "delta" map, which
+//     topK() adds to the row. Delta counts for pruned neighbours are only
+//     partial until the next load rebuilds the rows.
+// ---------------------------------------------------------------------
+class CoBorrowIndex {
+public:
+    static const size_t MAX_ROW = 32;
+
+private:
+    unordered_map<string,uint32_t> ids;
+    vector<string>   titles;
+    vector<uint32_t> rowStart; // row i is [rowStart[i], rowStart[i+1])
+    vector<uint32_t> cols;     // neighbour title ids
+    vector<uint32_t> counts;   // patrons who returned both
+    unordered_map<uint32_t, unordered_map<uint32_t,uint32_t>> delta;
+
+    uint32_t intern(const string &title) {
+        auto it = ids.find(title);
+        if(it!=ids.end()) return it->second;
+        uint32_t id = (uint32_t)titles.size();
+        ids[title] = id;
+        titles.push_back(title);
+        return id;
+    }
+
+    static uint64_t pairKey(uint32_t a, uint32_t b) {
+        return (uint64_t(a)<<32) | b;
+    }
+
+    // Strongest first; ties by title id so results are stable
+    static bool stronger(const pair<uint32_t,uint32_t> &x, const pair<uint32_t,uint32_t> &y) {
+        return x.second!=y.second ? x.second>y.second : x.first<y.first;
+    }
+
+public:
+    void build(const vector<vector<string>> &histories) {
+        // Each history as a sorted set of title ids
+        vector<vector<uint32_t>> sets;
+        for(auto &h : histories) {
+            vector<uint32_t> ts;
+            for(auto &t : h) ts.push_back(intern(t));
+            sort(ts.begin(), ts.end());
+            ts.erase(unique(ts.begin(), ts.end()), ts.end());
+            sets.push_back(ts);
+        }
+
+        // Each thread takes every n-th user and emits both (a,b) and (b,a)
+        // into bucket a%n; thread k then owns every row r with r%n==k, so
+        // sorting, counting and pruning need no locks and no merge step
+        size_t nThreads = max<size_t>(1, thread::hardware_concurrency());
+        nThreads = min(nThreads, max<size_t>(1, sets.size()));
+        vector<vector<vector<uint64_t>>> buckets(nThreads, vector<vector<uint64_t>>(nThreads));
+        vector<thread> workers;
+        for(size_t k=0; k<nThreads; k++) {
+            workers.emplace_back([&, k]{
+                for(size_t u=k; u<sets.size(); u+=nThreads) {
+                    const vector<uint32_t> &ts = sets[u];
+                    for(size_t i=0; i<ts.size(); i++) {
+                        for(size_t j=i+1; j<ts.size(); j++) {
+                            buckets[k][ts[i]%nThreads].push_back(pairKey(ts[i], ts[j]));
+                            buckets[k][ts[j]%nThreads].push_back(pairKey(ts[j], ts[i]));
+                        }
+                    }
+                }
+            });
+        }
+        for(auto &t : workers) t.join();
+
+        vector<vector<pair<uint32_t,uint32_t>>> rows(titles.size());
+        workers.clear();
+        for(size_t k=0; k<nThreads; k++) {
+            workers.emplace_back([&, k]{
+                vector<uint64_t> keys;
+                for(size_t src=0; src<nThreads; src++) {
+                    keys.insert(keys.end(), buckets[src][k].begin(), buckets[src][k].end());
+                    vector<uint64_t>().swap(buckets[src][k]);
+                }
+                sort(keys.begin(), keys.end());
+                for(size_t i=0; i<keys.size(); ) {
+                    size_t j = i;
+                    while(j<keys.size() && keys[j]==keys[i]) j++;
+                    rows[(uint32_t)(keys[i]>>32)].push_back({(uint32_t)keys[i], (uint32_t)(j-i)});
+                    i = j;
+                }
+                for(size_t r=k; r<rows.size(); r+=nThreads) {
+                    auto &row = rows[r];
+                    size_t keep = min(row.size(), MAX_ROW);
+                    partial_sort(row.begin(), row.begin()+keep, row.end(), stronger);
+                    row.resize(keep);
+                    row.shrink_to_fit();
+                }
+            });
+        }
+        for(auto &t : workers) t.join();
+
+        rowStart.assign(1, 0);
+        cols.clear();
+        counts.clear();
+        for(auto &row : rows) {
+            for(auto &e : row) {
+                cols.push_back(e.first);
+                counts.push_back(e.second);
+            }
+            rowStart.push_back((uint32_t)cols.size());
+        }
+        delta.clear();
+    }
+
+    // A user with "history" is returning "title"
+    void recordReturn(const vector<string> &history, const string &title) {
+        if(find(history.begin(), history.end(), title)!=history.end()) {
+            return; // this user already counts toward every pair with it
+        }
+        uint32_t t = intern(title);
+        vector<uint32_t> others;
+        for(auto &h : history) others.push_back(intern(h));
+        sort(others.begin(), others.end());
+        others.erase(unique(others.begin(), others.end()), others.end());
+        for(uint32_t o : others) {
+            delta[t][o]++;
+            delta[o][t]++;
+        }
+    }
+
+    // Up to k titles most often borrowed by patrons who also borrowed "title"
+    vector<pair<string,uint32_t>> topK(const string &title, size_t k) const {
+        vector<pair<string,uint32_t>> res;
+        auto it = ids.find(title);
+        if(it==ids.end()) return res;
+        uint32_t t = it->second;
+
+        vector<pair<uint32_t,uint32_t>> cand;
+        if(t+1 < rowStart.size()) {
+            for(uint32_t j=rowStart[t]; j<rowStart[t+1]; j++) {
+                cand.push_back({cols[j], counts[j]});
+            }
+        }
+        auto d = delta.find(t);
+        if(d!=delta.end()) {
+            for(auto &e : d->second) {
+                auto c = find_if(cand.begin(), cand.end(),
+                                 [&](const pair<uint32_t,uint32_t> &x){ return x.first==e.first; });
+                if(c!=cand.end()) c->second += e.second;
+                else cand.push_back(e);
+            }
+        }
+        size_t keep = min(cand.size(), k);
+        partial_sort(cand.begin(), cand.begin()+keep, cand.end(), stronger);
+        for(size_t i=0; i<keep; i++) {
+            res.push_back({titles[cand[i].first], cand[i].second});
+        }
+        return res;
+    }
+};
+
+const size_t CoBorrowIndex::MAX_ROW;
+
+// ---------------------------------------------------------------------
+// Class: CatalogSnapshot
+//   - Consistent point-in-time view of every shard and of account state
+//   - Taking one copies a page-table pointer per shard and the current
+//     VersionClock::seq; nothing is copied per book or per user
+//   - Fines and histories are read back through User::getFineAt() and
+//     User::getHistoryAt() with the snapshot's sequence number. The
+//     accounts list itself is fixed after load, so it is not copied.
+// ---------------------------------------------------------------------
+class CatalogSnapshot {
+private:
+    vector<string>               names;
+    vector<CowPages<Book>::View> views;
+    long long                    seq;
+    VersionClock*                clock;
+    const vector<Account>*       accounts;
+
+public:
+    // Caller holds clock->mtx
+    CatalogSnapshot(const vector<LibraryShard> &shards, VersionClock* c,
+                    const vector<Account>* accs)
+      : seq(c->seq), clock(c), accounts(accs) {
+        for(auto &s : shards) {
+            names.push_back(s.getName());
+            views.push_back(s.getBooks().snapshot());
+        }
+        clock->openSnapshots++;
+    }
+    ~CatalogSnapshot() {
+        lock_guard<recursive_mutex> g(clock->mtx);
+        clock->openSnapshots--;
+    }
+    CatalogSnapshot(const CatalogSnapshot&) = delete;
+    CatalogSnapshot& operator=(const CatalogSnapshot&) = delete;
+
+    size_t    shardCount() const                     { return views.size(); }
+    string    shardName(size_t i) const              { return names[i]; }
+    const CowPages<Book>::View& books(size_t i) const { return views[i]; }
+    long long getSeq() const                         { return seq; }
+    const vector<Account>& getAccounts() const       { return *accounts; }
+};
+
+// ---------------------------------------------------------------------
+// Class: Library
+//   - Manages the catalog shards and a vector<Account>
+//   - Shards are either one per branch, or hash-partitioned by ISBN
+//     (shard = isbnHash(ISBN) % number of shards)
+//   - On startup, loads every shard in parallel. On destruction, saves
+//     only the shards that changed, plus the accounts and holds files.
+//   - Keeps a PatronTally per user (books out, copies reserved for them,
+//     queues joined), updated on every borrow, return, hold and handoff,
+//     so limit checks never scan the catalog
+//   - Hold queues are kept per title in "holdsByTitle"
+//   - Reports and exports read from a CatalogSnapshot, so they never see
+//     a half-done borrow/return and never hold up the next one
+// ---------------------------------------------------------------------
+class Library {
+private:
+    // One parsed feed row; "seq" is the line its ISBN first appeared on,
+    // so a repeat takes over the data but not the place in feed order
+    struct FeedRow {
+        size_t seq;
+        Book   book;
+    };
+
+    struct PatronTally {
+        multiset<int> dueDays;  // one per book out, earliest first
+        int reserved;           // copies waiting for them to pick up
+        int queued;             // hold queues they are in
+        PatronTally() : reserved(0), queued(0) {}
+    };
+
+    vector<LibraryShard> shards;
+    bool            hashByISBN;
+    string          accountFile;
+    VersionClock    clock;
+    vector<Account> accounts;
+    unordered_map<string, User*> usersByID;
+    unordered_map<string, PatronTally> tallies;     // by userID
+    string          holdFile;
+    unordered_map<string, HoldQueue> holdsByTitle;
+    bool            holdsDirty;
+    // Last pickup day of each reservation handed out: (day, (title, userID)).
+    // Entries for copies already picked up are skipped when they come due.
+    multimap<int, pair<string,string>> pickupDeadlines;
+    CoBorrowIndex   coBorrow;
+    vector<future<void>> pendingExports;
+
+public:
+    // Single-branch library using BookData.csv, as before
+    Library() : Library(vector<string>{"BookData.csv"}, false) {}
+
+    // bookFiles: one entry per shard, either "file.csv" or "Name=file.csv"
+    Library(const vector<string> &bookFiles, bool byISBN,
+            const string &accFile = "AccountData.csv",
+            const string &hFile = "HoldData.csv")
+      : hashByISBN(byISBN), accountFile(accFile), holdFile(hFile), holdsDirty(false) {
+        for(auto &spec : bookFiles) {
+            size_t eq = spec.find('=');
+            string file = (eq==string::npos) ? spec : spec.substr(eq+1);
+            string nm   = (eq==string::npos) ? file : spec.substr(0, eq);
+            if(eq==string::npos && nm.size()>4 && nm.substr(nm.size()-4)==".csv") {
+                nm = nm.substr(0, nm.size()-4);
+            }
+            shards.emplace_back(nm, file);
+        }
+        loadShards();
+        loadAccounts(accountFile);
+        loadHolds(holdFile);
+        buildTallies();
+        releaseLapsedHolds();
+        for(auto &t : titlesWithHolds()) serveHolds(t); // copies freed offline
+        buildCoBorrowIndex();
+    }
+    ~Library() {
+        for(auto &f : pendingExports) f.wait();
+        for(auto &s : shards) {
+            if(s.isDirty()) s.saveBooks();
+        }
+        saveAccounts(accountFile);
+        if(holdsDirty) saveHolds(holdFile);
+        // Also must delete the user objects allocated in loadAccounts
+        for(auto &acc : accounts) {
+            delete acc.getUser();
+        }
+    }
+
+    // ----------------------------
+    // Shards
+    // ----------------------------
+
+    // Each shard reads its own file on its own thread
+    void loadShards() {
+        vector<thread> workers;
+        vector<string> warnings(shards.size());
+        for(size_t i=0; i<shards.size(); i++) {
+            workers.emplace_back([this, i, &warnings]{ warnings[i] = shards[i].loadBooks(); });
+        }
+        for(auto &t : workers) t.join();
+        for(auto &w : warnings) {
+            if(!w.empty()) cerr<<w<<"\n";
+        }
+        if(hashByISBN) rebalance();
+    }
+
+    // In hash mode, move any book sitting in the wrong file to its owner.
+    // This also lets an existing single file be split: pass it along with
+    // the new (empty) shard files and every book is routed on first load.
+    void rebalance() {
+        for(size_t i=0; i<shards.size(); i++) {
+            vector<Book> moved = shards[i].extractIf([&](const Book &b){
+                return shardIndexForISBN(b.getISBN()) != i;
+            });
+            for(auto &b : moved) {
+                shards[shardIndexForISBN(b.getISBN())].addBook(b);
+            }
+        }
+    }
+
+    size_t shardIndexForISBN(const string &isbn) const {
+        return isbnHash(isbn) % shards.size();
+    }
+
+    LibraryShard* findShard(const string &name) {
+        for(auto &s : shards) {
+            if(s.getName()==name) return &s;
         }
         return nullptr;
     }
 
-    void listAllBooks() {
-        if(books.empty()){
-            cout<<"No books.\n";
+    // The shard holding "b", so a change goes to that shard's pages and
+    // marks only that file for saving
+    LibraryShard* shardOf(const Book* b) {
+        for(auto &s : shards) {
+            if(s.owns(b)) return &s;
+        }
+        return nullptr;
+    }
+
+    bool isMultiBranch() const { return shards.size()>1; }
+    bool isHashPartitioned() const { return hashByISBN; }
+
+    // Consistent view of all shards and account state, taken in O(shards)
+    shared_ptr<const CatalogSnapshot> snapshot() {
+        lock_guard<recursive_mutex> g(clock.mtx);
+        return make_shared<const CatalogSnapshot>(shards, &clock, &accounts);
+    }
+
+    // A title can have copies in several branches. Pick the one this user
+    // should act on: their own (borrowed or held for them) first, then an
+    // available copy, then the first one found.
+    static const Book* pickCopy(const vector<const Book*> &copies, const string &userID) {
+        for(auto b : copies) {
+            if(!userID.empty() && b->getBorrowedBy()==userID) return b;
+        }
+        for(auto b : copies) {
+            if(b->getStatus()=="Available") return b;
+        }
+        return copies.empty() ? nullptr : copies.front();
+    }
+
+    // For convenience in code
+    const Book* findBookByTitle(const string &title, const string &userID = "") {
+        vector<const Book*> copies;
+        for(auto &s : shards) {
+            s.findCopies(title, false, copies);
+        }
+        return pickCopy(copies, userID);
+    }
+
+    // Goes straight to the owning shard when hash-partitioned
+    const Book* findBookByISBN(const string &isbn, const string &userID = "") {
+        vector<const Book*> copies;
+        if(hashByISBN) {
+            shards[shardIndexForISBN(isbn)].findCopies(isbn, true, copies);
+        } else {
+            for(auto &s : shards) {
+                s.findCopies(isbn, true, copies);
+            }
+        }
+        return pickCopy(copies, userID);
+    }
+
+    // What the borrow/return menus type in: a title, or failing that an ISBN
+    const Book* findBook(const string &key, const string &userID = "") {
+        releaseLapsedHolds(); // so a lapsed reservation isn't reported as taken
+        const Book* b = findBookByTitle(key, userID);
+        return b ? b : findBookByISBN(key, userID);
+    }
+
+    // Cross-branch search: every shard of one snapshot is searched
+    // concurrently and the results are merged in title order, each tagged
+    // with its branch
+    void searchBooks(const string &query) {
+        typedef pair<size_t, const Book*> Hit; // (shard, book)
+        auto snap = snapshot();
+        vector<future<vector<Hit>>> parts;
+        for(size_t i=0; i<snap->shardCount(); i++) {
+            const CowPages<Book>::View *view = &snap->books(i);
+            parts.push_back(async(launch::async, [i, view, &query]{
+                vector<Hit> res;
+                for(size_t j=0; j<view->size(); j++) {
+                    const Book &b = view->at(j);
+                    if(b.getTitle().find(query)!=string::npos ||
+                       b.getAuthor().find(query)!=string::npos) {
+                        res.push_back(Hit(i, &b));
+                    }
+                }
+                return res;
+            }));
+        }
+        vector<Hit> res;
+        for(auto &f : parts) {
+            vector<Hit> part = f.get();
+            res.insert(res.end(), part.begin(), part.end());
+        }
+        stable_sort(res.begin(), res.end(), [](const Hit &x, const Hit &y){
+            return x.second->getTitle() < y.second->getTitle();
+        });
+        if(res.empty()) {
+            cout<<"No matching books.\n";
             return;
         }
-        cout<<"--- All Books ---\n";
-        for(auto &b : books) {
-            b.printInfo();
+        cout<<"--- "<<res.size()<<" match(es) ---\n";
+        for(auto &h : res) {
+            if(isMultiBranch()) cout<<"["<<snap->shardName(h.first)<<"] ";
+            h.second->printInfo();
         }
     }
 
+    void listAllBooks() {
+        releaseLapsedHolds();
+        auto snap = snapshot();
+        bool any = false;
+        for(size_t i=0; i<snap->shardCount(); i++) {
+            const CowPages<Book>::View &view = snap->books(i);
+            if(view.size()==0) continue;
+            if(!any) cout<<"--- All Books ---\n";
+            any = true;
+            if(isMultiBranch()) cout<<"["<<snap->shardName(i)<<"]\n";
+            for(size_t j=0; j<view.size(); j++) {
+                view.at(j).printInfo();
+            }
+        }
+        if(!any) cout<<"No books.\n";
+    }
+
+    // Overdue books with the borrower's fine, all as of one moment
+    void overdueReport() {
+        auto snap = snapshot();
+        int today = currentDayFromEpoch();
+        int n = 0;
+        cout<<"--- Overdue Books ---\n";
+        for(size_t i=0; i<snap->shardCount(); i++) {
+            const CowPages<Book>::View &view = snap->books(i);
+            for(size_t j=0; j<view.size(); j++) {
+                const Book &b = view.at(j);
+                if(b.getStatus()!="Borrowed") continue;
+                int overdueDays = diffInDays(today, b.getDueDate());
+                if(overdueDays<=0) continue;
+                User* u = findUserByID(b.getBorrowedBy());
+                cout<<b.getTitle()<<" | "<<b.getBorrowedBy()
+                    <<" | "<<overdueDays<<" days overdue";
+                if(u) cout<<" | current fine "<<u->getFineAt(snap->getSeq());
+                cout<<"\n";
+                n++;
+            }
+        }
+        if(n==0) cout<<"None.\n";
+    }
+
+    // Writes the whole catalog, as of now, to "fname" and each user's
+    // fine and history to "<fname>_accounts.csv", on a background thread;
+    // borrowing, returning and paying fines carry on meanwhile
+    void exportCatalog(const string &fname) {
+        string accName = fname;
+        if(accName.size()>4 && accName.substr(accName.size()-4)==".csv") {
+            accName = accName.substr(0, accName.size()-4);
+        }
+        accName += "_accounts.csv";
+        auto bookOut = make_shared<ofstream>(fname, ios::out);
+        auto accOut  = make_shared<ofstream>(accName, ios::out);
+        if(!bookOut->is_open() || !accOut->is_open()) {
+            cout<<"Could not open "<<(bookOut->is_open() ? accName : fname)<<" for writing.\n";
+            return;
+        }
+
+        // Forget exports that have already finished
+        pendingExports.erase(remove_if(pendingExports.begin(), pendingExports.end(),
+            [](const future<void> &f){
+                return f.wait_for(chrono::seconds(0)) == future_status::ready;
+            }), pendingExports.end());
+
+        auto snap = snapshot();
+        pendingExports.push_back(async(launch::async, [snap, bookOut, accOut]{
+            bool wrote = false;
+            for(size_t i=0; i<snap->shardCount(); i++) {
+                if(snap->books(i).size()==0) continue;
+                if(wrote) *bookOut<<"\n";
+                LibraryShard::writeBooks(*bookOut, snap->books(i));
+                wrote = true;
+            }
+            // Format: userID,role,fine,historyBook1,historyBook2,...
+            const vector<Account> &accs = snap->getAccounts();
+            for(size_t i=0; i<accs.size(); i++) {
+                User* u = accs[i].getUser();
+                if(!u) continue;
+                *accOut<<u->getUserID()<<","<<accs[i].getRole()<<","
+                       <<u->getFineAt(snap->getSeq());
+                for(auto &h : u->getHistoryAt(snap->getSeq())) {
+                    *accOut<<","<<h;
+                }
+                if(i<accs.size()-1) *accOut<<"\n";
+            }
+        }));
+        cout<<"Exporting catalog to "<<fname<<" and "<<accName<<" in the background.\n";
+    }
+
     // Librarian actions
+    //  - In hash mode the ISBN decides the shard and "branch" is ignored
+    //  - Otherwise the book goes to the named branch (first one if empty)
     void addBook(const string &t, const string &a, const string &i,
-                 const string &p, int y) {
+                 const string &p, int y, const string &branch = "") {
+        LibraryShard* s = &shards[0];
+        if(hashByISBN) {
+            s = &shards[shardIndexForISBN(i)];
+        } else if(!branch.empty()) {
+            s = findShard(branch);
+            if(!s) {
+                cout<<"No branch named "<<branch<<".\n";
+                return;
+            }
+        }
         Book b(t,a,i,p,y);
-        books.push_back(b);
+        lock_guard<recursive_mutex> g(clock.mtx);
+        s->addBook(b);
         cout<<"Book added.\n";
+        serveHolds(t);
     }
+    // Removes every copy of the title, and its hold queue with it
     void removeBook(const string &title) {
-        auto it = remove_if(books.begin(), books.end(), [&](Book &b){
-            return (b.getTitle()==title);
-        });
-        if(it==books.end()) {
+        lock_guard<recursive_mutex> g(clock.mtx);
+        size_t removed = 0;
+        for(auto &s : shards) {
+            vector<Book> gone = s.extractIf([&](const Book &b){
+                return (b.getTitle()==title);
+            });
+            for(auto &b : gone) {
+                PatronTally &t = tallies[b.getBorrowedBy()];
+                if(b.getStatus()=="Borrowed") {
+                    auto due = t.dueDays.find(b.getDueDate());
+                    if(due != t.dueDays.end()) t.dueDays.erase(due);
+                } else if(b.getStatus()=="Reserved") {
+                    t.reserved--;
+                }
+            }
+            removed += gone.size();
+        }
+        if(removed==0) {
             cout<<"No book with that title.\n";
         } else {
-            books.erase(it, books.end());
+            auto it = holdsByTitle.find(title);
+            if(it!=holdsByTitle.end()) {
+                for(size_t i=0; i<it->second.size(); i++) {
+                    tallies[it->second[i]].queued--;
+                }
+                holdsByTitle.erase(it);
+                holdsDirty = true;
+            }
             cout<<"Removed.\n";
         }
     }
 
+    // ----------------------------
+    // Bulk import of a publisher feed
+    //   Feed format: Title,Author,ISBN,Publisher,Year (more columns ignored)
+    //   - Fields are trimmed. ISBNs are matched on isbnKey(), so hyphens and
+    //     spaces do not matter, but are stored as the feed writes them.
+    //   - Lines are read in batches. Each batch is parsed by several
+    //     threads, which route every row to partition
+    //     isbnHash(isbnKey) % threads.
+    //   - Partition p is only ever touched by thread p and keeps the last
+    //     row seen per ISBN, so repeats inside the feed collapse unlocked
+    //   - One pass then upserts into the catalog: new ISBNs are added in
+    //     the order of their first line in the feed; existing ones get the
+    //     feed's title, author, publisher and year, while status, borrower
+    //     and dates are kept. When a title changes, its hold queue and any
+    //     pickup deadlines follow the copies to the new title.
+    // ----------------------------
+
+    // True for a "Title,Author,ISBN,..." header line (any case)
+    static bool isFeedHeader(const string &line) {
+        static const char* names[] = {"title", "author", "isbn"};
+        stringstream ss(line);
+        string temp;
+        for(const char* name : names) {
+            if(!getline(ss,temp,',')) return false;
+            temp = trimmed(temp);
+            for(auto &c : temp) c = (char)tolower((unsigned char)c);
+            if(temp!=name) return false;
+        }
+        return true;
+    }
+
+    // False for a malformed row (too few fields, no title/ISBN, bad year)
+    static bool parseFeedLine(const string &line, Book &out) {
+        vector<string> tok;
+        stringstream ss(line);
+        string temp;
+        while(getline(ss,temp,',')) {
+            tok.push_back(trimmed(temp));
+        }
+        if(tok.size()<5 || tok[0].empty() || isbnKey(tok[2]).empty()) return false;
+        const char* ys = tok[4].c_str();
+        char* end = nullptr;
+        long y = strtol(ys, &end, 10);
+        if(end==ys || *end!='\0') return false;
+        out = Book(tok[0], tok[1], tok[2], tok[3], (int)y);
+        return true;
+    }
+
+    void importFeed(const string &fname, const string &branch = "") {
+        ifstream fin(fname);
+        if(!fin.is_open()) {
+            cout<<"Could not open "<<fname<<".\n";
+            return;
+        }
+        LibraryShard* target = &shards[0]; // where new titles go
+        if(!hashByISBN && !branch.empty()) {
+            target = findShard(branch);
+            if(!target) {
+                cout<<"No branch named "<<branch<<".\n";
+                return;
+            }
+        }
+
+        const size_t BATCH = 1<<16;
+        size_t nThreads = max<size_t>(1, thread::hardware_concurrency());
+        vector<unordered_map<string, FeedRow>> latest(nThreads); // per partition
+        size_t lineNo = 0, rejected = 0, repeats = 0;
+        vector<string> lines;
+        lines.reserve(BATCH);
+
+        auto processBatch = [&]{
+            size_t n = lines.size();
+            // Parse: thread k takes a contiguous slice of the batch
+            vector<vector<vector<FeedRow>>> routed(nThreads, vector<vector<FeedRow>>(nThreads));
+            vector<size_t> bad(nThreads, 0), dup(nThreads, 0);
+            vector<thread> workers;
+            for(size_t k=0; k<nThreads; k++) {
+                workers.emplace_back([&, k]{
+                    for(size_t i=n*k/nThreads; i<n*(k+1)/nThreads; i++) {
+                        FeedRow r;
+                        r.seq = lineNo + i;
+                        if(!parseFeedLine(lines[i], r.book)) { bad[k]++; continue; }
+                        routed[k][isbnHash(isbnKey(r.book.getISBN())) % nThreads].push_back(r);
+                    }
+                });
+            }
+            for(auto &t : workers) t.join();
+            // Dedup: thread p folds in partition p from every slice, in order
+            workers.clear();
+            for(size_t p=0; p<nThreads; p++) {
+                workers.emplace_back([&, p]{
+                    for(size_t k=0; k<nThreads; k++) {
+                        for(auto &r : routed[k][p]) {
+                            auto res = latest[p].emplace(isbnKey(r.book.getISBN()), r);
+                            if(!res.second) {
+                                size_t firstSeq = res.first->second.seq;
+                                res.first->second = r;
+                                res.first->second.seq = firstSeq;
+                                dup[p]++;
+                            }
+                        }
+                    }
+                });
+            }
+            for(auto &t : workers) t.join();
+            for(size_t k=0; k<nThreads; k++) {
+                rejected += bad[k];
+                repeats  += dup[k];
+            }
+            lineNo += n;
+            lines.clear();
+        };
+
+        string line;
+        bool first = true;
+        while(getline(fin, line)) {
+            if(!line.empty() && line.back()=='\r') line.pop_back();
+            if(line.empty()) continue;
+            if(first) {
+                first = false;
+                if(isFeedHeader(line)) continue;
+            }
+            lines.push_back(line);
+            if(lines.size()==BATCH) processBatch();
+        }
+        processBatch();
+        fin.close();
+
+        vector<FeedRow> feed;
+        for(auto &m : latest) {
+            for(auto &e : m) feed.push_back(e.second);
+            m.clear();
+        }
+        sort(feed.begin(), feed.end(), [](const FeedRow &x, const FeedRow &y){
+            return x.seq < y.seq;
+        });
+
+        // Every current catalog row per ISBN: (shard, position)
+        unordered_map<string, vector<pair<size_t,size_t>>> where;
+        for(size_t si=0; si<shards.size(); si++) {
+            const CowPages<Book> &books = shards[si].getBooks();
+            for(size_t i=0; i<books.size(); i++) {
+                where[isbnKey(books.at(i).getISBN())].push_back({si, i});
+            }
+        }
+
+        size_t inserted = 0, updated = 0, unchanged = 0;
+        vector<pair<string,string>> renamed; // (old title, new title)
+        lock_guard<recursive_mutex> g(clock.mtx);
+        for(auto &r : feed) {
+            const Book &nb = r.book;
+            auto it = where.find(isbnKey(nb.getISBN()));
+            if(it==where.end()) {
+                LibraryShard* s = hashByISBN ? &shards[shardIndexForISBN(nb.getISBN())] : target;
+                s->addBook(nb);
+                if(holdsByTitle.count(nb.getTitle())) serveHolds(nb.getTitle());
+                inserted++;
+                continue;
+            }
+            bool changed = false;
+            for(auto &loc : it->second) {
+                const Book &cur = shards[loc.first].getBooks().at(loc.second);
+                if(cur.getTitle()==nb.getTitle() && cur.getAuthor()==nb.getAuthor() &&
+                   cur.getPublisher()==nb.getPublisher() && cur.getYear()==nb.getYear()) {
+                    continue;
+                }
+                if(cur.getTitle()!=nb.getTitle()) {
+                    renamed.push_back({cur.getTitle(), nb.getTitle()});
+                    if(cur.getStatus()=="Reserved") {
+                        movePickupDeadline(cur, nb.getTitle());
+                    }
+                }
+                shards[loc.first].updateAt(loc.second, [&](Book &w){
+                    w.setTitle(nb.getTitle());
+                    w.setAuthor(nb.getAuthor());
+                    w.setPublisher(nb.getPublisher());
+                    w.setYear(nb.getYear());
+                });
+                changed = true;
+            }
+            if(changed) updated++;
+            else        unchanged++;
+        }
+        for(auto &r : renamed) {
+            vector<const Book*> left;
+            for(auto &s : shards) s.findCopies(r.first, false, left);
+            if(left.empty()) moveHolds(r.first, r.second);
+            serveHolds(r.second);
+        }
+
+        cout<<"Imported "<<fname<<": "<<inserted<<" inserted, "<<updated<<" updated, "
+            <<unchanged<<" unchanged, "<<rejected<<" rejected";
+        if(repeats>0) cout<<" ("<<repeats<<" repeated ISBNs in the feed, last one kept)";
+        cout<<".\n";
+    }
+
     // ----------------------------
     // Account / User I/O
     // ----------------------------
@@ -472,6 +1626,8 @@ public:
                     uptr->addHistory(tok[i]);
                 }
             }
+            uptr->setClock(&clock);
+            usersByID[uid] = uptr;
             // Make an Account
             Account acc(un, pw, role, uptr);
             accounts.push_back(acc);
@@ -491,6 +1647,9 @@ public:
             <<acc.getRole()<<","
             <<uptr->getUserID()<<","
             <<uptr->getFine();
+        for(auto &h : uptr->getHistory()) {
+            fout<<","<<h;
+        }
 
         if(i<accounts.size()-1) fout<<"\n";
     }
@@ -510,6 +1669,7 @@ public:
     for(auto &acc : accounts) {
         if(acc.getUsername() == un) {
             if(acc.checkPassword(pw)) {  // ✅ Uses checkPassword() here
+                releaseLapsedHolds();
                 return &acc;
             } else {
                 return nullptr;
@@ -519,56 +1679,57 @@ public:
     return nullptr;
 }
 
-    // Reconstruct a user's "current borrowed books" by scanning "books" array
-    // for Book::borrowedBy = user->userID
-    vector<Book*> gatherUserBorrowed(const string &userID) {
-        vector<Book*> res;
-        for(auto &bk: books) {
-            if(bk.getBorrowedBy() == userID && bk.getStatus()=="Borrowed") {
-                res.push_back(&bk);
-            }
-        }
-        return res;
+    User* findUserByID(const string &userID) {
+        auto it = usersByID.find(userID);
+        return (it==usersByID.end()) ? nullptr : it->second;
     }
 
     // ----------------------------
     // The key operation: Borrow
     //   - If user is Faculty, we also check if they have a book overdue by >60 days
     //   - If user is Student, we check if fine>0 or if they've reached 3 books
-    //   - If a book is "Available", we set it "Borrowed" w/ dueDate
+    //     (copies waiting for them to pick up count too)
+    //   - If a book is "Available", or "Reserved" for this user, we set it
+    //     "Borrowed" w/ dueDate; otherwise the user joins its hold queue
     // ----------------------------
-    void userBorrowBook(User* u, Book* b) {
+    void userBorrowBook(User* u, const Book* b) {
+    string id = u->getUserID();
+    bool heldForMe = (b->getStatus() == "Reserved" && b->getBorrowedBy() == id);
     if(dynamic_cast<Student*>(u)) {
-        auto userBooks = gatherUserBorrowed(u->getUserID());
-        if (!u->canBorrowMore(userBooks)) {
+        if (!u->canBorrowMore(loansOf(id, heldForMe))) {
             cout<<"Cannot borrow. You have reached the borrowing limit or have unpaid fines.\n";
             return;
         }
     } 
 
     if(dynamic_cast<Faculty*>(u)) {
-        auto userBooks = gatherUserBorrowed(u->getUserID());
-        for(auto &bk : userBooks) {
-            int overdueDays = diffInDays(currentDayFromEpoch(), bk->getDueDate());
-            if(overdueDays > 60) {
-                cout<<"Faculty cannot borrow more books as they have an overdue book exceeding 60 days.\n";
-                return;
-            }
+        if(hasLongOverdue(id)) {
+            cout<<"Faculty cannot borrow more books as they have an overdue book exceeding 60 days.\n";
+            return;
         }
     }
 
-    if(b->getStatus() == "Borrowed") {
+    lock_guard<recursive_mutex> g(clock.mtx);
+    if(b->getStatus() == "Borrowed" ||
+       (b->getStatus() == "Reserved" && b->getBorrowedBy() != id)) {
         cout<<"Book is already borrowed.\n";
+        placeHold(u, b);
         return;
     }
 
     // Update book status
-    b->setStatus("Borrowed");
-    b->setBorrowedBy(u->getUserID());
+    heldForMe = (b->getStatus() == "Reserved");
     int borrowDay = currentDayFromEpoch();
     int dueDay = borrowDay + u->getBorrowDays();
-    b->setBorrowDate(borrowDay);
-    b->setDueDate(dueDay);
+    b = shardOf(b)->update(b, [&](Book &w){
+        w.setStatus("Borrowed");
+        w.setBorrowedBy(id);
+        w.setBorrowDate(borrowDay);
+        w.setDueDate(dueDay);
+    });
+    PatronTally &t = tallies[id];
+    if(heldForMe) t.reserved--;
+    t.dueDays.insert(dueDay);
 
     cout<<"Successfully borrowed: "<<b->getTitle()<<". Due in "<<u->getBorrowDays()<<" days.\n";
 }
@@ -579,11 +1740,12 @@ public:
     //  - If overdue => compute daysOverdue
     //  - For Student => add fine
     //  - For Faculty => no fine
-    //  - Then Book => status=Available, borrowedBy="-None-"
+    //  - Then Book => status=Available, borrowedBy="-None-", or "Reserved"
+    //    for the next patron in its title's hold queue
     //  - Add to user history
     // ----------------------------
-    void userReturnBook(User* u, Book* b) {
-    if(b->getStatus() == "Available") {
+    void userReturnBook(User* u, const Book* b) {
+    if(b->getStatus() != "Borrowed") {
         cout<<"Book not borrowed.\n";
         return;
     }
@@ -596,6 +1758,8 @@ public:
     int today = currentDayFromEpoch();
     int overdueDays = diffInDays(today, b->getDueDate());
 
+    // Fine, book and history change together as one commit
+    lock_guard<recursive_mutex> g(clock.mtx);
     if(overdueDays > 0) {
         if(dynamic_cast<Student*>(u)) {
             u->handleOverdueBook(overdueDays);
@@ -609,23 +1773,307 @@ public:
     }
 
     // Update book status
-    b->setStatus("Available");
-    b->setBorrowedBy("-None-");
-    b->setBorrowDate(0);
-    b->setDueDate(0);
+    PatronTally &t = tallies[u->getUserID()];
+    auto due = t.dueDays.find(b->getDueDate());
+    if(due != t.dueDays.end()) t.dueDays.erase(due);
+    b = shardOf(b)->update(b, [](Book &w){
+        w.setStatus("Available");
+        w.setBorrowedBy("-None-");
+        w.setBorrowDate(0);
+        w.setDueDate(0);
+    });
+    b = handOff(b, today);
 
     // Add to user's history
+    coBorrow.recordReturn(u->getHistory(), b->getTitle());
     u->addHistory(b->getTitle());
     cout<<"Book returned successfully.\n";
+    if(b->getStatus() == "Reserved") {
+        cout<<"It is now held for "<<b->getBorrowedBy()
+            <<" until day "<<b->getDueDate()<<".\n";
+    }
 }
 
+    // ----------------------------
+    // Holds
+    // ----------------------------
+
+    // Title,F:FAC456;S:STU123  (one line per title with a queue)
+    void loadHolds(const string &fname) {
+        ifstream fin(fname);
+        if(!fin.is_open()) return; // no holds yet
+        string line;
+        while(getline(fin, line)) {
+            size_t comma = line.find(',');
+            if(comma==string::npos) continue;
+            holdsByTitle[line.substr(0, comma)].parse(line.substr(comma+1));
+        }
+        fin.close();
+    }
+
+    void saveHolds(const string &fname) {
+        ofstream fout(fname, ios::out);
+        bool first = true;
+        for(auto &e : holdsByTitle) {
+            if(e.second.empty()) continue;
+            if(!first) fout<<"\n";
+            fout<<e.first<<","<<e.second.toString();
+            first = false;
+        }
+        fout.close();
+        holdsDirty = false;
+    }
+
+    // One pass over the catalog and the queues at startup
+    void buildTallies() {
+        for(auto &s : shards) {
+            const CowPages<Book> &books = s.getBooks();
+            for(size_t i=0; i<books.size(); i++) {
+                const Book &bk = books.at(i);
+                if(bk.getStatus()=="Borrowed") {
+                    tallies[bk.getBorrowedBy()].dueDays.insert(bk.getDueDate());
+                } else if(bk.getStatus()=="Reserved") {
+                    tallies[bk.getBorrowedBy()].reserved++;
+                    pickupDeadlines.insert({bk.getDueDate(), {bk.getTitle(), bk.getBorrowedBy()}});
+                }
+            }
+        }
+        for(auto &e : holdsByTitle) {
+            for(size_t i=0; i<e.second.size(); i++) {
+                tallies[e.second[i]].queued++;
+            }
+        }
+    }
+
+    // What counts toward the borrow limit: books out plus copies held for
+    // pickup, less the one being picked up right now ("pickingUp")
+    int loansOf(const string &userID, bool pickingUp = false) {
+        const PatronTally &t = tallies[userID];
+        return (int)t.dueDays.size() + t.reserved - (pickingUp ? 1 : 0);
+    }
+
+    // Faculty rule: no new books while any is overdue by more than 60 days
+    bool hasLongOverdue(const string &userID) {
+        const multiset<int> &due = tallies[userID].dueDays;
+        return !due.empty() && diffInDays(currentDayFromEpoch(), *due.begin()) > 60;
+    }
+
+    // Could this user borrow right now? Same checks as userBorrowBook.
+    bool canTakeHandoff(User* u) {
+        if(!u) return false;
+        string id = u->getUserID();
+        if(!u->canBorrowMore(loansOf(id))) return false;
+        if(dynamic_cast<Faculty*>(u) && hasLongOverdue(id)) return false;
+        return true;
+    }
+
+    // Queue "u" for the title of "b" (every copy of it serves the queue).
+    // Loans, reservations and queued holds all count toward the limit.
+    void placeHold(User* u, const Book* b) {
+        string id = u->getUserID();
+        if(b->getBorrowedBy() == id) {
+            cout<<"You already have this book.\n";
+            return;
+        }
+        lock_guard<recursive_mutex> g(clock.mtx);
+        HoldQueue &q = holdsByTitle[b->getTitle()];
+        if(size_t pos = q.position(id)) {
+            cout<<"You are already in its hold queue (position "<<pos<<").\n";
+            return;
+        }
+        PatronTally &t = tallies[id];
+        if(!u->canBorrowMore(loansOf(id) + t.queued)) {
+            cout<<"Cannot place a hold. Your loans and holds have reached the limit.\n";
+            return;
+        }
+        q.push(id, dynamic_cast<Faculty*>(u) != nullptr);
+        t.queued++;
+        holdsDirty = true;
+        cout<<"Added to the hold queue (position "<<q.position(id)<<").\n";
+    }
+
+    // Reserve a copy that has just come free (returned, pickup lapsed, or
+    // newly added) for the next eligible holder of its title. Each holder
+    // is popped and checked in O(1); those who can no longer borrow (limit
+    // reached, unpaid fines, long overdue) are dropped. If nobody is left
+    // the copy becomes Available.
+    const Book* handOff(const Book* b, int today) {
+        lock_guard<recursive_mutex> g(clock.mtx);
+        if(b->getStatus()=="Reserved") {
+            tallies[b->getBorrowedBy()].reserved--; // their window lapsed
+        }
+        string next;
+        auto it = holdsByTitle.find(b->getTitle());
+        if(it!=holdsByTitle.end()) {
+            HoldQueue &q = it->second;
+            while(!q.empty() && next.empty()) {
+                string id = q.pop();
+                tallies[id].queued--;
+                holdsDirty = true;
+                if(canTakeHandoff(findUserByID(id))) next = id;
+            }
+            if(q.empty()) holdsByTitle.erase(it);
+        }
+        if(next.empty() && b->getStatus()=="Available") return b;
+        b = shardOf(b)->update(b, [&](Book &w){
+            if(next.empty()) {
+                w.setStatus("Available");
+                w.setBorrowedBy("-None-");
+                w.setBorrowDate(0);
+                w.setDueDate(0);
+            } else {
+                w.setStatus("Reserved");
+                w.setBorrowedBy(next);
+                w.setBorrowDate(today);
+                w.setDueDate(today + HoldQueue::PICKUP_DAYS);
+            }
+        });
+        if(!next.empty()) {
+            tallies[next].reserved++;
+            pickupDeadlines.insert({b->getDueDate(), {b->getTitle(), next}});
+        }
+        return b;
+    }
+
+    // Merge the queue for "from" into the one for "to" (a title was renamed
+    // and no copy keeps the old name). Patrons already waiting for "to"
+    // keep their place and are not queued twice.
+    void moveHolds(const string &from, const string &to) {
+        lock_guard<recursive_mutex> g(clock.mtx);
+        auto it = holdsByTitle.find(from);
+        if(from==to || it==holdsByTitle.end()) return;
+        HoldQueue old = it->second;
+        holdsByTitle.erase(it);
+        HoldQueue &q = holdsByTitle[to];
+        while(!old.empty()) {
+            string id = old.pop();
+            if(q.position(id)) { tallies[id].queued--; continue; }
+            q.push(id, dynamic_cast<Faculty*>(findUserByID(id)) != nullptr);
+        }
+        holdsDirty = true;
+    }
+
+    // Re-key the pickup deadline of Reserved copy "b" under "title"
+    void movePickupDeadline(const Book &b, const string &title) {
+        auto range = pickupDeadlines.equal_range(b.getDueDate());
+        for(auto it = range.first; it != range.second; ++it) {
+            if(it->second.first==b.getTitle() && it->second.second==b.getBorrowedBy()) {
+                it->second.first = title;
+                return;
+            }
+        }
+    }
+
+    vector<string> titlesWithHolds() const {
+        vector<string> res;
+        for(auto &e : holdsByTitle) res.push_back(e.first);
+        return res;
+    }
+
+    // Give every available copy of "title" to its queue, if it has one
+    void serveHolds(const string &title) {
+        lock_guard<recursive_mutex> g(clock.mtx);
+        while(holdsByTitle.count(title)) {
+            const Book* b = findBookByTitle(title);
+            if(!b || b->getStatus()!="Available") break;
+            handOff(b, currentDayFromEpoch());
+        }
+    }
+
+    // Pass on copies whose pickup window has run out. Cheap when nothing
+    // is due (one look at the earliest deadline), so it runs on login,
+    // before lookups and listings, and at startup. Lapsed reservations are
+    // dropped, not requeued.
+    void releaseLapsedHolds() {
+        lock_guard<recursive_mutex> g(clock.mtx);
+        int today = currentDayFromEpoch();
+        while(!pickupDeadlines.empty() && pickupDeadlines.begin()->first < today) {
+            int day = pickupDeadlines.begin()->first;
+            pair<string,string> who = pickupDeadlines.begin()->second;
+            pickupDeadlines.erase(pickupDeadlines.begin());
+            vector<const Book*> copies;
+            for(auto &s : shards) {
+                s.findCopies(who.first, false, copies);
+            }
+            for(auto b : copies) {
+                if(b->getStatus()=="Reserved" && b->getBorrowedBy()==who.second &&
+                   b->getDueDate()==day) {
+                    handOff(b, today);
+                    break;
+                }
+            }
+        }
+    }
+
+    // ----------------------------
+    // Recommendations
+    // ----------------------------
+    void buildCoBorrowIndex() {
+        vector<vector<string>> histories;
+        for(auto &acc : accounts) {
+            if(acc.getUser()) histories.push_back(acc.getUser()->getHistory());
+        }
+        coBorrow.build(histories);
+    }
+
+    void showAlsoBorrowed(const string &title) {
+        auto recs = coBorrow.topK(title, 5);
+        if(recs.empty()) {
+            cout<<"No recommendations for that title yet.\n";
+            return;
+        }
+        cout<<"Patrons who borrowed "<<title<<" also borrowed:\n";
+        for(auto &r : recs) {
+            cout<<" - "<<r.first<<" ("<<r.second<<" patron"<<(r.second==1 ? "" : "s")<<")\n";
+        }
+    }
+
+    void showHolds(User* u) {
+        releaseLapsedHolds();
+        string id = u->getUserID();
+        int n = 0;
+        if(tallies[id].reserved > 0) {
+            for(auto &s : shards) {
+                const CowPages<Book> &books = s.getBooks();
+                for(size_t i=0; i<books.size(); i++) {
+                    const Book &bk = books.at(i);
+                    if(bk.getStatus()=="Reserved" && bk.getBorrowedBy()==id) {
+                        cout<<" - "<<bk.getTitle()<<": ready for pickup until day "
+                            <<bk.getDueDate()<<"\n";
+                        n++;
+                    }
+                }
+            }
+        }
+        for(auto &e : holdsByTitle) {
+            if(size_t pos = e.second.position(id)) {
+                cout<<" - "<<e.first<<": position "<<pos
+                    <<" of "<<e.second.size()<<"\n";
+                n++;
+            }
+        }
+        if(n==0) cout<<"No holds.\n";
+    }
+
 };
 
 // ---------------------------------------------------------------------
 // Now a demonstration main:
+//   ./main                          -> single branch, BookData.csv
+//   ./main Main=A.csv East=B.csv    -> one shard per branch
+//   ./main --hash A.csv B.csv C.csv -> books hash-partitioned by ISBN
 // ---------------------------------------------------------------------
-int main() {
-    Library lib;
+int main(int argc, char* argv[]) {
+    FrameBuffer screen; // first, so it outlives everything that prints
+    bool byISBN = false;
+    vector<string> bookFiles;
+    for(int i=1; i<argc; i++) {
+        string arg = argv[i];
+        if(arg=="--hash") byISBN = true;
+        else bookFiles.push_back(arg);
+    }
+    if(bookFiles.empty()) bookFiles.push_back("BookData.csv");
+    Library lib(bookFiles, byISBN);
     while(true) {
         Clear();
         cout<<"=== LIBRARY SYSTEM ===\n"
@@ -660,6 +2108,9 @@ int main() {
                         <<"1. List all books\n"
                         <<"2. Add book\n"
                         <<"3. Remove book\n"
+                        <<"4. Overdue report\n"
+                        <<"5. Export catalog\n"
+                        <<"6. Import publisher feed\n"
                         <<"0. Logout\n"
                         <<"Choice: ";
                     int lc; cin>>lc;
@@ -679,9 +2130,14 @@ int main() {
                         string i; getline(cin,i);
                         cout<<"Publisher: ";
                         string p; getline(cin,p);
+                        string br;
+                        if(lib.isMultiBranch() && !lib.isHashPartitioned()) {
+                            cout<<"Branch: ";
+                            getline(cin,br);
+                        }
                         cout<<"Year: ";
                         int y; cin>>y;
-                        lib.addBook(t,a,i,p,y);
+                        lib.addBook(t,a,i,p,y,br);
                         cin.ignore();cin.get();
                     } else if(lc==3) {
                         Clear();
@@ -690,6 +2146,29 @@ int main() {
                         string t; getline(cin,t);
                         lib.removeBook(t);
                         cin.ignore();cin.get();
+                    } else if(lc==4) {
+                        Clear();
+                        lib.overdueReport();
+                        cin.ignore();cin.get();
+                    } else if(lc==5) {
+                        Clear();
+                        cout<<"Export to file: ";
+                        cin.ignore();
+                        string f; getline(cin,f);
+                        lib.exportCatalog(f);
+                        cin.get();
+                    } else if(lc==6) {
+                        Clear();
+                        cout<<"Feed file: ";
+                        cin.ignore();
+                        string f; getline(cin,f);
+                        string br;
+                        if(lib.isMultiBranch() && !lib.isHashPartitioned()) {
+                            cout<<"Branch for new titles: ";
+                            getline(cin,br);
+                        }
+                        lib.importFeed(f, br);
+                        cin.get();
                     } else {
                         cout<<"Invalid.\n";
                         cin.ignore();cin.get();
@@ -707,6 +2186,9 @@ int main() {
                         <<"3. Return a book\n"
                         <<"4. Pay Fines (Student only)\n"
                         <<"5. Show returned-book history\n"
+                        <<"6. Search books (title/author)\n"
+                        <<"7. My holds\n"
+                        <<"8. Patrons also borrowed...\n"
                         <<"0. Logout\n"
                         <<"Choice: ";
                     int uc; cin>>uc;
@@ -719,10 +2201,10 @@ int main() {
                     else if(uc==2) {
                         // borrow
                         Clear();
-                        cout<<"Enter book title to borrow: ";
+                        cout<<"Enter book title (or ISBN) to borrow: ";
                         cin.ignore();
                         string bt; getline(cin,bt);
-                        Book* b = lib.findBookByTitle(bt);
+                        const Book* b = lib.findBook(bt, u->getUserID());
                         if(!b) {
                             cout<<"No book found.\n";
                         } else {
@@ -733,10 +2215,10 @@ int main() {
                     else if(uc==3) {
                         // return
                         Clear();
-                        cout<<"Enter book title to return: ";
+                        cout<<"Enter book title (or ISBN) to return: ";
                         cin.ignore();
                         string bt; getline(cin, bt);
-                        Book* b = lib.findBookByTitle(bt);
+                        const Book* b = lib.findBook(bt, u->getUserID());
                         if(!b) {
                             cout<<"No such book.\n";
                         } else {
@@ -759,6 +2241,27 @@ int main() {
                         u->showHistory();
                         cin.ignore();cin.get();
                     }
+                    else if(uc==6) {
+                        Clear();
+                        cout<<"Search for: ";
+                        cin.ignore();
+                        string q; getline(cin,q);
+                        lib.searchBooks(q);
+                        cin.get();
+                    }
+                    else if(uc==7) {
+                        Clear();
+                        lib.showHolds(u);
+                        cin.ignore();cin.get();
+                    }
+                    else if(uc==8) {
+                        Clear();
+                        cout<<"Book title: ";
+                        cin.ignore();
+                        string bt; getline(cin,bt);
+                        lib.showAlsoBorrowed(bt);
+                        cin.get();
+                    }
                     else {
                         cout<<"Invalid.\n";
                         cin.ignore();cin.get();